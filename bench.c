@@ -0,0 +1,201 @@
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "leptjson.h"
+
+#define BENCH_RECORDS 100000
+#define BENCH_ROUNDS 10
+
+// 生成根为数组的测试文档: [ [ 序号, 价格, "名称", 布尔, null, [ 1, 2, 3 ] ], ... ]
+static char *bench_make_json(size_t records) {
+    size_t i, n = 0, size = records * 64 + 16;
+    char *json = (char *)malloc(size);
+    n += sprintf(json + n, "[");
+    for (i = 0; i < records; i++)
+        n += sprintf(json + n, "%s[%u,%.3f,\"item-%u\",%s,null,[1,2,3]]",
+            i ? "," : "", (unsigned)i, i * 0.125, (unsigned)i, i & 1 ? "true" : "false");
+    sprintf(json + n, "]");
+    return json;
+}
+
+// 生成与bench_make_json内容相同、按4空格缩进美化输出的文档
+static char *bench_make_pretty_json(size_t records) {
+    size_t i, n = 0, size = records * 192 + 16;
+    char *json = (char *)malloc(size);
+    n += sprintf(json + n, "[\n");
+    for (i = 0; i < records; i++)
+        n += sprintf(json + n,
+            "    [\n        %u,\n        %.3f,\n        \"item-%u\",\n        %s,\n        null,\n"
+            "        [\n            1,\n            2,\n            3\n        ]\n    ]%s\n",
+            (unsigned)i, i * 0.125, (unsigned)i, i & 1 ? "true" : "false", i + 1 < records ? "," : "");
+    sprintf(json + n, "]\n");
+    return json;
+}
+
+// 只含字面量的美化输出文档，主要开销在空白和字面量上
+static char *bench_make_pretty_literals(size_t records) {
+    static const char *literals[] = { "true", "false", "null" };
+    size_t i, n = 0, size = records * 96 + 16;
+    char *json = (char *)malloc(size);
+    n += sprintf(json + n, "[\n");
+    for (i = 0; i < records; i++)
+        n += sprintf(json + n, "    [\n        %s,\n        %s,\n        [\n            %s\n        ]\n    ]%s\n",
+            literals[i % 3], literals[(i + 1) % 3], literals[(i + 2) % 3], i + 1 < records ? "," : "");
+    sprintf(json + n, "]\n");
+    return json;
+}
+
+static double bench_ms(clock_t start) {
+    return (clock() - start) * 1000.0 / CLOCKS_PER_SEC / BENCH_ROUNDS;
+}
+
+// 取多轮中最快的一次，减少机器负载带来的波动
+static void bench_parse(const char *name, const char *json) {
+    lept_value v;
+    clock_t start;
+    double ms, best = 0.0;
+    int i;
+    lept_init(&v);
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+        start = clock();
+        lept_parse(&v, json);
+        lept_free(&v);
+        ms = bench_ms(start) * BENCH_ROUNDS;
+        if (i == 0 || ms < best)
+            best = ms;
+    }
+    printf("  lept_parse %-12s%8.2f ms (%u bytes)\n", name, best, (unsigned)strlen(json));
+}
+
+static void bench_binary(const char *json) {
+    lept_value v;
+    char *blob;
+    size_t length;
+    clock_t start;
+    int i;
+
+    lept_init(&v);
+    start = clock();
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+        lept_parse(&v, json);
+        lept_free(&v);
+    }
+    printf("  lept_parse             %8.2f ms\n", bench_ms(start));
+
+    lept_parse(&v, json);
+    blob = lept_encode_binary(&v, &length);
+    lept_free(&v);
+    printf("  text %u bytes, binary %u bytes\n", (unsigned)strlen(json), (unsigned)length);
+
+    start = clock();
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+        lept_decode_binary(&v, blob, length);
+        lept_free(&v);
+    }
+    printf("  lept_decode_binary     %8.2f ms\n", bench_ms(start));
+
+    start = clock();
+    for (i = 0; i < BENCH_ROUNDS; i++) {
+        lept_decode_binary_view(&v, blob, length);
+        lept_free_binary_view(&v);
+    }
+    printf("  lept_decode_binary_view%8.2f ms\n", bench_ms(start));
+    free(blob);
+}
+
+static double bench_wall_ms(struct timespec *start) {
+    struct timespec end;
+    timespec_get(&end, TIME_UTC);
+    return ((end.tv_sec - start->tv_sec) * 1000.0 + (end.tv_nsec - start->tv_nsec) / 1e6) / BENCH_ROUNDS;
+}
+
+// 多线程时clock()统计的是所有线程的CPU时间，这里用墙上时间
+static void bench_parallel(const char *json) {
+    static const int threads[] = { 1, 2, 4, 8 };
+    lept_value v;
+    struct timespec start;
+    size_t t;
+    int i;
+    for (t = 0; t < sizeof(threads) / sizeof(threads[0]); t++) {
+        timespec_get(&start, TIME_UTC);
+        for (i = 0; i < BENCH_ROUNDS; i++) {
+            lept_parse_parallel(&v, json, threads[t]);
+            lept_free(&v);
+        }
+        printf("  lept_parse_parallel %d  %8.2f ms\n", threads[t], bench_wall_ms(&start));
+    }
+}
+
+#define BENCH_MESSAGES 1000000
+
+typedef struct {
+    int id;
+    double price;
+    char *name;
+    int paid;
+} bench_order;
+
+static const lept_field bench_order_fields[] = {
+    { "id", offsetof(bench_order, id), LEPT_BIND_INT, NULL },
+    { "price", offsetof(bench_order, price), LEPT_BIND_NUMBER, NULL },
+    { "name", offsetof(bench_order, name), LEPT_BIND_STRING, NULL },
+    { "paid", offsetof(bench_order, paid), LEPT_BIND_BOOLEAN, NULL },
+    { NULL }
+};
+
+// 解析库还不支持对象，parse+copy用等价的数组形式消息作对照(输入更短，对其有利)
+static void bench_bind() {
+    static const char *object = "{ \"id\": 12345, \"price\": 99.125, \"name\": \"item-12345\", "
+        "\"tags\": [ 1, 2, 3 ], \"paid\": true }";
+    static const char *array = "[ 12345, 99.125, \"item-12345\", [ 1, 2, 3 ], true ]";
+    bench_order o;
+    lept_value v;
+    clock_t start;
+    size_t len;
+    int i;
+
+    memset(&o, 0, sizeof(o));
+    start = clock();
+    for (i = 0; i < BENCH_MESSAGES; i++) {
+        lept_parse_bind(&o, bench_order_fields, object);
+        lept_free_bind(&o, bench_order_fields);
+    }
+    printf("  lept_parse_bind        %8.2f ms\n", (clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+
+    lept_init(&v);
+    start = clock();
+    for (i = 0; i < BENCH_MESSAGES; i++) {
+        lept_parse(&v, array);
+        o.id = (int)lept_get_number(lept_get_array_element(&v, 0));
+        o.price = lept_get_number(lept_get_array_element(&v, 1));
+        len = lept_get_string_length(lept_get_array_element(&v, 2));
+        o.name = (char *)malloc(len + 1);
+        memcpy(o.name, lept_get_string(lept_get_array_element(&v, 2)), len + 1);
+        o.paid = lept_get_boolean(lept_get_array_element(&v, 4));
+        lept_free(&v);
+        free(o.name);
+    }
+    printf("  lept_parse + copy      %8.2f ms\n", (clock() - start) * 1000.0 / CLOCKS_PER_SEC);
+}
+
+int main(int argc, char* argv[]) {
+    char *json = bench_make_json(BENCH_RECORDS);
+    char *pretty = bench_make_pretty_json(BENCH_RECORDS);
+    char *literals = bench_make_pretty_literals(BENCH_RECORDS);
+    printf("Parse (%d records, best of %d):\n", BENCH_RECORDS, BENCH_ROUNDS);
+    bench_parse("compact", json);
+    bench_parse("pretty", pretty);
+    bench_parse("literals", literals);
+    free(pretty);
+    free(literals);
+    printf("Binary cache round-trip (%d records):\n", BENCH_RECORDS);
+    bench_binary(json);
+    printf("Parallel parse (%d records):\n", BENCH_RECORDS);
+    bench_parallel(json);
+    printf("Bind %d messages:\n", BENCH_MESSAGES);
+    bench_bind();
+    free(json);
+    return 0;
+}
@@ -3,16 +3,52 @@
 #include <crtdbg.h>
 #endif
 #include "leptjson.h"
+#ifdef _WIN32
+#include <windows.h> /* CreateThread() */
+#else
+#include <pthread.h> /* pthread_create() */
+#endif
 #include <assert.h>  /* assert() */
 #include <errno.h>   /* errno, ERANGE */
+#include <limits.h>  /* INT_MIN, INT_MAX */
 #include <math.h>    /* HUGE_VAL */
+#include <stdint.h>  /* uint32_t, uint64_t, uintptr_t, UINT32_MAX */
 #include <stdlib.h>  /* NULL, malloc(), realloc(), free(), strtod() */
-#include <string.h>  /* memcpy() */
+#include <string.h>  /* memcpy(), memmove(), memcmp(), strlen() */
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h> /* _mm_loadu_si128() */
+#define LEPT_SSE2
+#ifdef _MSC_VER
+#include <intrin.h>    /* _BitScanForward() */
+#endif
+#endif
 
 #ifndef LEPT_PARSE_STACK_INIT_SIZE
 #define LEPT_PARSE_STACK_INIT_SIZE 256
 #endif
 
+// 并行解析时每个线程至少分到的字节数，文档太小时直接串行解析
+#ifndef LEPT_PARSE_PARALLEL_MIN_CHUNK
+#define LEPT_PARSE_PARALLEL_MIN_CHUNK (64 * 1024)
+#endif
+
+// 按字(word)读取时可能越过字符串结尾'\0'，只要不跨页就不会访问到无效内存
+// 读到的多余字节只参与比较，不影响结果；ASan会误报这类读取，所以对读取函数关闭检查
+#define LEPT_PAGE_SIZE 4096
+#define LEPT_CAN_LOAD(p, n) (((uintptr_t)(p) & (LEPT_PAGE_SIZE - 1)) <= LEPT_PAGE_SIZE - (n))
+#if defined(__SANITIZE_ADDRESS__)
+#define LEPT_ASAN
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define LEPT_ASAN
+#endif
+#endif
+#ifdef LEPT_ASAN
+#define LEPT_NO_SANITIZE_ADDRESS __attribute__((no_sanitize_address))
+#else
+#define LEPT_NO_SANITIZE_ADDRESS
+#endif
+
 #define EXPECT(_c, _ch) \
 do { \
 assert(*_c->json == _ch); \
@@ -51,21 +87,88 @@ static void* lept_context_pop(lept_context *c, size_t size) {
     return c->stack + (c->top -= size);
 }
 
+// 数组元素前放一个头部记录容量，lept_value本身不增加字段
+// 头部用union保证其后的元素按lept_value的要求对齐
+typedef union {
+    size_t capacity;
+    double n;
+    void *p;
+} lept_array_header;
+
+#define LEPT_ARRAY_HEADER(e) ((lept_array_header *)(e) - 1)
+// borrowed的数组元素位于视图pool或调用者提供的内存中，没有头部，不可realloc/free
+#define LEPT_ARRAY_OWNED(v) (!(v)->borrowed)
+
+static lept_value *lept_array_realloc(lept_value *e, size_t capacity) {
+    lept_array_header *h = (lept_array_header *)realloc(e ? LEPT_ARRAY_HEADER(e) : NULL,
+        sizeof(lept_array_header) + capacity * sizeof(lept_value));
+    h->capacity = capacity;
+    return (lept_value *)(h + 1);
+}
+
+// 在*p处放置一个借用的元素块，*p前进到块之后
+static lept_value *lept_array_borrow(char **p, size_t size) {
+    lept_value *e = (lept_value *)*p;
+    *p += size * sizeof(lept_value);
+    return e;
+}
+
+LEPT_NO_SANITIZE_ADDRESS static uint32_t lept_load32(const char *p) {
+    uint32_t u;
+    memcpy(&u, p, sizeof(u));       // 非对齐读取，编译器会生成单条load指令
+    return u;
+}
+
+// 返回p开始的连续空格数，一次最多检查LEPT_SPACES_STEP个字节
+#ifdef LEPT_SSE2
+#define LEPT_SPACES_STEP 16
+LEPT_NO_SANITIZE_ADDRESS static size_t lept_count_spaces(const char *p) {
+    __m128i x = _mm_loadu_si128((const __m128i *)p);
+    unsigned mask = ~(unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')));
+#ifdef _MSC_VER
+    unsigned long i;
+    _BitScanForward(&i, mask);      // mask高16位为1，不会为0
+    return i;
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+#else
+#define LEPT_SPACES_STEP 8
+LEPT_NO_SANITIZE_ADDRESS static size_t lept_count_spaces(const char *p) {
+    uint64_t u;
+    memcpy(&u, p, sizeof(u));
+    return u == 0x2020202020202020ULL ? 8 : 0;
+}
+#endif
+
 static void lept_parse_whitespace(lept_context *c) {
     const char *p = c->json;
-    while(*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')
-    ++p;
+    while(*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r') {
+        ++p;
+        // 美化输出的缩进多为"\n"加N个空格，连续空格整块跳过
+        if (*p == ' ' && LEPT_CAN_LOAD(p, LEPT_SPACES_STEP))
+            p += lept_count_spaces(p);
+    }
     c->json = p;
 }
 
+// literal长度为4或5，比较最后4个字节即可(5字节时首字节已由lept_parse_value确认)
 static int lept_parse_literal(lept_context *c, lept_value *v, const char *literal, lept_type type) {
-    size_t i;
+    size_t i, len = strlen(literal);
+    const char *p = c->json + len - 4;
+    assert(len == 4 || len == 5);
     EXPECT(c, literal[0]);
-    // for(i = 0; literal[i + 1] != '\0'; i++)        // 使用literal本身判断
-    for (i = 0; literal[i + 1]; i++)
-        if (c->json[i] != literal[i + 1])
+    if (LEPT_CAN_LOAD(p, 4)) {
+        if (lept_load32(p) != lept_load32(literal + len - 4))
             return LEPT_PARSE_INVALID_VALUE;
-    c->json += i;
+    }
+    else {
+        for (i = 0; literal[i + 1]; i++)
+            if (c->json[i] != literal[i + 1])
+                return LEPT_PARSE_INVALID_VALUE;
+    }
+    c->json += len - 1;
     v->type = type;
     return LEPT_PARSE_OK;
 }
@@ -143,9 +246,10 @@ static void lept_encode_utf8(lept_context* c, unsigned u) {
 
 #define STRING_ERROR(ret) do { c->top = head; return ret; } while(0)
 
-static int lept_parse_string(lept_context *c, lept_value *v) {
+// 解码后的字符串留在栈上(已弹出但未覆盖)，由调用者在下次压栈前取走
+static int lept_parse_string_raw(lept_context *c, char **str, size_t *len) {
     unsigned u, u2;     // 用于解析Unicode字符.
-    size_t head = c->top, len;      // 备份栈顶，用于计算字符串长度
+    size_t head = c->top;      // 备份栈顶，用于计算字符串长度
     const char *p;
     EXPECT(c, '\"');
     p = c->json;
@@ -153,8 +257,8 @@ static int lept_parse_string(lept_context *c, lept_value *v) {
         char ch = *p++;
         switch(ch) {
             case '\"':
-                len = c->top - head;
-                lept_set_string(v, (const char*)lept_context_pop(c, len), len);
+                *len = c->top - head;
+                *str = (char *)lept_context_pop(c, *len);
                 c->json = p;        // 这里不明白
             return LEPT_PARSE_OK;
 			case '\\':      // 转义字符
@@ -197,11 +301,20 @@ static int lept_parse_string(lept_context *c, lept_value *v) {
     }
 }
 
+static int lept_parse_string(lept_context *c, lept_value *v) {
+    int ret;
+    char *s;
+    size_t len;
+    if ((ret = lept_parse_string_raw(c, &s, &len)) == LEPT_PARSE_OK)
+        lept_set_string(v, s, len);
+    return ret;
+}
+
 // 向前声明
 static int lept_parse_value(lept_context* c, lept_value* v);
 
 static int lept_parse_array(lept_context* c, lept_value* v) {
-    size_t size = 0;
+    size_t i, size = 0;
     int ret;
     EXPECT(c, '[');
     lept_parse_whitespace(c);
@@ -215,26 +328,35 @@ static int lept_parse_array(lept_context* c, lept_value* v) {
     for (;;) {
         lept_value e;
         lept_init(&e);
-        if ((ret == lept_parse_value(c, &e) != LEPT_PARSE_OK))
-            return ret;
+        if ((ret = lept_parse_value(c, &e)) != LEPT_PARSE_OK)
+            break;
         memcpy(lept_context_push(c, sizeof(lept_value)), &e, sizeof(lept_value));
         size++;
-        if (*c->json == ',')
+        lept_parse_whitespace(c);
+        if (*c->json == ',') {
             c->json++;
+            lept_parse_whitespace(c);
+        }
         else if (*c->json == ']') {
             c->json++;
             v->type = LEPT_ARRAY;
+            v->u.a.e = lept_array_realloc(NULL, size);
             v->u.a.size = size;
             size *= sizeof(lept_value);
-            memcpy(v->u.a.e = (lept_value*)malloc(size), lept_context_pop(c, size), size);
+            memcpy(v->u.a.e, lept_context_pop(c, size), size);
             return LEPT_PARSE_OK;
         }
-        else
-            return LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+        else {
+            ret = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+            break;
+        }
     }
+    // 出错时弹出并释放已解析的元素
+    for (i = 0; i < size; i++)
+        lept_free((lept_value*)lept_context_pop(c, sizeof(lept_value)));
+    return ret;
 }
 
-
 static int lept_parse_value(lept_context* c, lept_value* v) {
     switch (*c->json) {
 		case 't':
@@ -254,6 +376,176 @@ static int lept_parse_value(lept_context* c, lept_value* v) {
     }
 }
 
+// 跳过一个值：与lept_parse_value有相同的语法检查和错误码，但不分配内存
+// 对象尚未有DOM表示，这里按JSON语法跳过，供lept_parse_bind忽略未知字段
+static int lept_skip_value(lept_context* c);
+
+static int lept_skip_string(lept_context* c) {
+    unsigned u, u2;
+    const char *p;
+    EXPECT(c, '\"');
+    p = c->json;
+    for (;;) {
+        char ch = *p++;
+        switch (ch) {
+            case '\"':
+                c->json = p;
+                return LEPT_PARSE_OK;
+            case '\\':
+                switch (*p++) {
+                    case '\"': case '\\': case '/':
+                    case 'b': case 'f': case 'n': case 'r': case 't':
+                        break;
+                    case 'u':
+                        if (!(p = lept_parse_hex4(p, &u)))
+                            return LEPT_PARSE_INVALID_UNICODE_HEX;
+                        if (u >= 0xD800 && u <= 0xDBFF) {
+                            if (*p++ != '\\' || *p++ != 'u')
+                                return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+                            if (!(p = lept_parse_hex4(p, &u2)))
+                                return LEPT_PARSE_INVALID_UNICODE_HEX;
+                            if (u2 < 0xDC00 || u2 > 0xDFFF)
+                                return LEPT_PARSE_INVALID_UNICODE_SURROGATE;
+                        }
+                        break;
+                    default:
+                        return LEPT_PARSE_INVALID_STRING_ESCAPE;
+                }
+                break;
+            case '\0':
+                return LEPT_PARSE_MISS_QUOTATION_MARK;
+            default:
+                if ((unsigned char)ch < 0x20)
+                    return LEPT_PARSE_INVALID_STRING_CHAR;
+        }
+    }
+}
+
+static int lept_skip_array(lept_context* c) {
+    int ret;
+    EXPECT(c, '[');
+    lept_parse_whitespace(c);
+    if (*c->json == ']') {
+        c->json++;
+        return LEPT_PARSE_OK;
+    }
+    for (;;) {
+        if ((ret = lept_skip_value(c)) != LEPT_PARSE_OK)
+            return ret;
+        lept_parse_whitespace(c);
+        if (*c->json == ',') {
+            c->json++;
+            lept_parse_whitespace(c);
+        }
+        else if (*c->json == ']') {
+            c->json++;
+            return LEPT_PARSE_OK;
+        }
+        else
+            return LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+    }
+}
+
+static int lept_skip_object(lept_context* c) {
+    int ret;
+    EXPECT(c, '{');
+    lept_parse_whitespace(c);
+    if (*c->json == '}') {
+        c->json++;
+        return LEPT_PARSE_OK;
+    }
+    for (;;) {
+        if (*c->json != '"')
+            return LEPT_PARSE_MISS_KEY;
+        if ((ret = lept_skip_string(c)) != LEPT_PARSE_OK)
+            return ret;
+        lept_parse_whitespace(c);
+        if (*c->json != ':')
+            return LEPT_PARSE_MISS_COLON;
+        c->json++;
+        lept_parse_whitespace(c);
+        if ((ret = lept_skip_value(c)) != LEPT_PARSE_OK)
+            return ret;
+        lept_parse_whitespace(c);
+        if (*c->json == ',') {
+            c->json++;
+            lept_parse_whitespace(c);
+        }
+        else if (*c->json == '}') {
+            c->json++;
+            return LEPT_PARSE_OK;
+        }
+        else
+            return LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+    }
+}
+
+// 只有带指数或整数部分超过308位时才可能溢出，其余情况不必调用strtod
+static int lept_skip_number(lept_context* c) {
+    const char *p = c->json, *digits;
+    lept_value v;
+    if (*p == '-') ++p;
+    digits = p;
+    if (*p == '0') ++p;
+    else {
+        if (!ISDIGIT1TO9(*p)) return LEPT_PARSE_INVALID_VALUE;
+        for (++p; ISDIGIT(*p); ++p);
+    }
+    if (p - digits > 308) {
+        lept_init(&v);
+        return lept_parse_number(c, &v);
+    }
+    if (*p == '.') {
+        ++p;
+        if (!ISDIGIT(*p)) return LEPT_PARSE_INVALID_VALUE;
+        for (++p; ISDIGIT(*p); ++p);
+    }
+    if (*p == 'e' || *p == 'E') {
+        lept_init(&v);
+        return lept_parse_number(c, &v);
+    }
+    c->json = p;
+    return LEPT_PARSE_OK;
+}
+
+static int lept_skip_value(lept_context* c) {
+    lept_value v;
+    switch (*c->json) {
+        case '"':
+            return lept_skip_string(c);
+        case '[':
+            return lept_skip_array(c);
+        case '{':
+            return lept_skip_object(c);
+        case 't': case 'f': case 'n': case '\0':
+            lept_init(&v);      // 字面量不会分配内存，直接复用解析函数
+            return lept_parse_value(c, &v);
+        default:
+            return lept_skip_number(c);
+    }
+}
+
+// 解析对象的键：不含转义时直接指向原文，不必逐字节压栈；
+// 否则解码到栈上(已弹出)，须在下次压栈前使用
+static int lept_parse_key(lept_context* c, const char **key, size_t *len) {
+    const char *q;
+    char *s;
+    int ret;
+    if (*c->json != '"')
+        return LEPT_PARSE_MISS_KEY;
+    for (q = c->json + 1; *q != '"' && *q != '\\' && (unsigned char)*q >= 0x20; q++);
+    if (*q == '"') {
+        *key = c->json + 1;
+        *len = q - c->json - 1;
+        c->json = q + 1;
+        return LEPT_PARSE_OK;
+    }
+    if ((ret = lept_parse_string_raw(c, &s, len)) != LEPT_PARSE_OK)
+        return ret;
+    *key = s;
+    return LEPT_PARSE_OK;
+}
+
 int lept_parse(lept_value* v, const char* json) {
     lept_context c;
     int ret;
@@ -266,7 +558,7 @@ int lept_parse(lept_value* v, const char* json) {
     if((ret = lept_parse_value(&c, v)) == LEPT_PARSE_OK) {
         lept_parse_whitespace(&c);
         if (*c.json != '\0') {
-            v->type = LEPT_NULL;
+            lept_free(v);
         	ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
         }
 	}
@@ -275,11 +567,311 @@ int lept_parse(lept_value* v, const char* json) {
     return ret;
 }
 
+// 并行解析中一个线程负责的一段顶层元素: [json, end)，end为分隔的','或结尾的']'
+typedef struct {
+    const char *json, *end;
+    lept_value *e;
+    size_t size;
+    int ret;
+} lept_chunk;
+
+static void lept_parse_chunk(lept_chunk *k) {
+    lept_context c;
+    size_t i;
+    c.json = k->json;
+    c.stack = NULL;
+    c.size = c.top = 0;
+    k->e = NULL;
+    k->size = 0;
+    for (;;) {
+        lept_value e;
+        lept_init(&e);
+        lept_parse_whitespace(&c);
+        if ((k->ret = lept_parse_value(&c, &e)) != LEPT_PARSE_OK)
+            break;
+        memcpy(lept_context_push(&c, sizeof(lept_value)), &e, sizeof(lept_value));
+        k->size++;
+        lept_parse_whitespace(&c);
+        if (c.json == k->end) {
+            k->e = (lept_value *)c.stack;       // 栈中即为连续的元素
+            return;
+        }
+        if (c.json > k->end || *c.json != ',') {
+            k->ret = LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+            break;
+        }
+        c.json++;
+    }
+    for (i = 0; i < k->size; i++)
+        lept_free((lept_value *)lept_context_pop(&c, sizeof(lept_value)));
+    k->size = 0;
+    free(c.stack);
+}
+
+#ifdef _WIN32
+typedef HANDLE lept_thread;
+static DWORD WINAPI lept_parse_chunk_thread(LPVOID arg) {
+    lept_parse_chunk((lept_chunk *)arg);
+    return 0;
+}
+static int lept_thread_create(lept_thread *t, lept_chunk *k) {
+    return (*t = CreateThread(NULL, 0, lept_parse_chunk_thread, k, 0, NULL)) != NULL;
+}
+static void lept_thread_join(lept_thread t) {
+    WaitForSingleObject(t, INFINITE);
+    CloseHandle(t);
+}
+#else
+typedef pthread_t lept_thread;
+static void *lept_parse_chunk_thread(void *arg) {
+    lept_parse_chunk((lept_chunk *)arg);
+    return NULL;
+}
+static int lept_thread_create(lept_thread *t, lept_chunk *k) {
+    return pthread_create(t, NULL, lept_parse_chunk_thread, k) == 0;
+}
+static void lept_thread_join(lept_thread t) {
+    pthread_join(t, NULL);
+}
+#endif
+
+// 预扫描：跳过字符串、记录嵌套深度，在每个目标偏移之后的第一个顶层','处切分
+// 返回根数组结尾']'的位置，文档不是以']'结尾的完整数组时返回NULL(交给串行解析报错)
+static const char *lept_split_array(const char *p, size_t len, lept_chunk *chunks, size_t *n) {
+    const char *begin = p, *target;
+    size_t k = 1, depth = 1, want = *n;
+    chunks[0].json = ++p;       // 跳过'['
+    target = begin + len / want;
+    for (;; p++) {
+        switch (*p) {
+            case '"':
+                for (p++; *p != '"'; p++) {
+                    if (*p == '\\')
+                        p++;
+                    if (*p == '\0')
+                        return NULL;
+                }
+                break;
+            case '[': case '{':
+                depth++;
+                break;
+            case ']': case '}':
+                if (--depth == 0) {
+                    if (*p != ']')      // 根数组必须以']'结尾，否则交给串行解析报错
+                        return NULL;
+                    chunks[k - 1].end = p;
+                    *n = k;
+                    return p;
+                }
+                break;
+            case ',':
+                if (depth == 1 && p >= target && k < want) {
+                    chunks[k - 1].end = p;
+                    chunks[k++].json = p + 1;
+                    target = begin + len / want * k;
+                }
+                break;
+            case '\0':
+                return NULL;
+            default: break;
+        }
+    }
+}
+
+int lept_parse_parallel(lept_value *v, const char *json, int threads) {
+    lept_context c;
+    lept_chunk *chunks;
+    lept_thread *tids;
+    int *started;
+    const char *p, *end;
+    size_t i, n, size = 0, len;
+    int ok = 1;
+    assert(v != NULL && json != NULL);
+    c.json = json;      // 只借用lept_parse_whitespace，不使用栈
+    c.stack = NULL;
+    c.size = c.top = 0;
+    lept_parse_whitespace(&c);
+    p = c.json;
+    len = strlen(p);
+    if (*p != '[' || threads <= 1 || len / LEPT_PARSE_PARALLEL_MIN_CHUNK < 2)
+        return lept_parse(v, json);
+    n = len / LEPT_PARSE_PARALLEL_MIN_CHUNK;
+    if (n > (size_t)threads)
+        n = (size_t)threads;
+    chunks = (lept_chunk *)malloc(n * sizeof(lept_chunk));
+    tids = (lept_thread *)malloc(n * sizeof(lept_thread));
+    started = (int *)calloc(n, sizeof(int));
+    end = lept_split_array(p, len, chunks, &n);
+    // 根数组之后只能有空白；空数组或只切出一段时串行解析更快
+    if (end) {
+        c.json = end + 1;
+        lept_parse_whitespace(&c);
+    }
+    if (!end || *c.json != '\0' || n < 2) {
+        free(chunks);
+        free(tids);
+        free(started);
+        return lept_parse(v, json);
+    }
+    for (i = 1; i < n; i++)
+        started[i] = lept_thread_create(&tids[i], &chunks[i]);
+    lept_parse_chunk(&chunks[0]);
+    for (i = 1; i < n; i++) {
+        if (started[i])
+            lept_thread_join(tids[i]);
+        else
+            lept_parse_chunk(&chunks[i]);       // 线程创建失败时在当前线程解析
+    }
+    for (i = 0; i < n; i++) {
+        ok = ok && chunks[i].ret == LEPT_PARSE_OK;
+        size += chunks[i].size;
+    }
+    lept_init(v);
+    if (ok) {
+        // 拼接各段的元素，所有权直接转移，无需深拷贝
+        lept_set_array(v, size);
+        for (i = 0; i < n; i++) {
+            memcpy(v->u.a.e + v->u.a.size, chunks[i].e, chunks[i].size * sizeof(lept_value));
+            v->u.a.size += chunks[i].size;
+        }
+    }
+    for (i = 0; i < n; i++) {
+        if (!ok) {
+            while (chunks[i].size)
+                lept_free(&chunks[i].e[--chunks[i].size]);
+        }
+        free(chunks[i].e);
+    }
+    free(chunks);
+    free(tids);
+    free(started);
+    // 出错时串行重新解析，保证错误码与lept_parse一致
+    return ok ? LEPT_PARSE_OK : lept_parse(v, json);
+}
+
 void lept_free(lept_value *v) {
+    size_t i;
     assert(v != NULL);
-    if(v->type == LEPT_STRING)
-        free(v->u.s.s);
-    v->type = LEPT_NULL;
+    switch (v->borrowed ? LEPT_NULL : v->type) {      // 借用的内存不归该值所有
+        case LEPT_STRING:
+            free(v->u.s.s);
+            break;
+        case LEPT_ARRAY:
+            for (i = 0; i < v->u.a.size; i++)
+                lept_free(&v->u.a.e[i]);
+            if (v->u.a.e)
+                free(LEPT_ARRAY_HEADER(v->u.a.e));
+            break;
+        default: break;
+    }
+    lept_init(v);
+}
+
+// dst须为未持有内存的值
+static void lept_copy_value(lept_value *dst, const lept_value *src) {
+    size_t i;
+    switch (src->type) {
+        case LEPT_STRING:
+            lept_set_string(dst, src->u.s.s, src->u.s.len);
+            break;
+        case LEPT_ARRAY:
+            dst->u.a.size = src->u.a.size;
+            dst->u.a.e = src->u.a.size ? lept_array_realloc(NULL, src->u.a.size) : NULL;
+            for (i = 0; i < src->u.a.size; i++) {
+                lept_init(&dst->u.a.e[i]);
+                lept_copy_value(&dst->u.a.e[i], &src->u.a.e[i]);
+            }
+            dst->type = LEPT_ARRAY;
+            break;
+        default:
+            memcpy(dst, src, sizeof(lept_value));
+            dst->borrowed = 0;
+            break;
+    }
+}
+
+// 先拷贝到临时值再转移，src是dst的子节点时也安全
+void lept_copy(lept_value *dst, const lept_value *src) {
+    lept_value temp;
+    assert(dst != NULL && src != NULL);
+    lept_init(&temp);
+    lept_copy_value(&temp, src);
+    lept_move(dst, &temp);
+}
+
+// 转移所有权，O(1)：src的u.a.e/u.s.s交给dst，src置为null
+// src借用内存时没有所有权可转移，退化为深拷贝，src保持不变
+void lept_move(lept_value *dst, lept_value *src) {
+    lept_value temp;
+    assert(dst != NULL && src != NULL);
+    if (dst == src)
+        return;
+    if (src->borrowed) {
+        lept_copy(dst, src);
+        return;
+    }
+    memcpy(&temp, src, sizeof(lept_value));
+    lept_init(src);         // src可能是dst的子节点，须在释放dst之前取走
+    lept_free(dst);
+    memcpy(dst, &temp, sizeof(lept_value));
+}
+
+// borrowed标记随值一起交换，即使违反约定也不会释放借用的内存
+void lept_swap(lept_value *lhs, lept_value *rhs) {
+    assert(lhs != NULL && rhs != NULL && !lhs->borrowed && !rhs->borrowed);
+    if (lhs != rhs) {
+        lept_value temp;
+        memcpy(&temp, lhs, sizeof(lept_value));
+        memcpy(lhs, rhs, sizeof(lept_value));
+        memcpy(rhs, &temp, sizeof(lept_value));
+    }
+}
+
+// nodes为元素块的字节数
+static void lept_copy_count(const lept_value *v, size_t *nodes, size_t *chars) {
+    size_t i;
+    if (v->type == LEPT_STRING)
+        *chars += v->u.s.len + 1;
+    else if (v->type == LEPT_ARRAY && v->u.a.size) {
+        *nodes += v->u.a.size * sizeof(lept_value);
+        for (i = 0; i < v->u.a.size; i++)
+            lept_copy_count(&v->u.a.e[i], nodes, chars);
+    }
+}
+
+size_t lept_copy_size(const lept_value *src) {
+    size_t nodes = 0, chars = 0;
+    assert(src != NULL);
+    lept_copy_count(src, &nodes, &chars);
+    return nodes + chars;
+}
+
+// 节点在前、字符串在后，保证lept_value的对齐
+static void lept_copy_packed(lept_value *dst, const lept_value *src, char **nodes, char **chars) {
+    size_t i;
+    memcpy(dst, src, sizeof(lept_value));
+    dst->borrowed = 1;
+    if (src->type == LEPT_STRING) {
+        dst->u.s.s = *chars;
+        memcpy(*chars, src->u.s.s, src->u.s.len + 1);
+        *chars += src->u.s.len + 1;
+    }
+    else if (src->type == LEPT_ARRAY && src->u.a.size) {
+        dst->u.a.e = lept_array_borrow(nodes, src->u.a.size);
+        for (i = 0; i < src->u.a.size; i++)
+            lept_copy_packed(&dst->u.a.e[i], &src->u.a.e[i], nodes, chars);
+    }
+}
+
+void lept_copy_into(lept_value *dst, const lept_value *src, void *buf) {
+    size_t nodes = 0, chars = 0;
+    char *n, *s;
+    assert(dst != NULL && src != NULL && dst != src);
+    lept_copy_count(src, &nodes, &chars);
+    assert(buf != NULL || nodes + chars == 0);
+    n = (char *)buf;
+    s = n + nodes;
+    lept_copy_packed(dst, src, &n, &s);
 }
 
 lept_type lept_get_type(const lept_value* v) {
@@ -337,4 +929,552 @@ lept_value *lept_get_array_element(const lept_value *v, size_t index) {
     assert(v != NULL && v->type == LEPT_ARRAY);
     assert(index < v->u.a.size);
     return &v->u.a.e[index];
-}
\ No newline at end of file
+}
+
+void lept_set_array(lept_value *v, size_t capacity) {
+    assert(v != NULL);
+    lept_free(v);
+    v->type = LEPT_ARRAY;
+    v->u.a.size = 0;
+    v->u.a.e = capacity > 0 ? lept_array_realloc(NULL, capacity) : NULL;
+}
+
+// 借用的数组(视图、lept_copy_into的结果)没有自己的存储，容量为0
+size_t lept_get_array_capacity(const lept_value *v) {
+    assert(v != NULL && v->type == LEPT_ARRAY);
+    return LEPT_ARRAY_OWNED(v) && v->u.a.e ? LEPT_ARRAY_HEADER(v->u.a.e)->capacity : 0;
+}
+
+void lept_reserve_array(lept_value *v, size_t capacity) {
+    assert(v != NULL && v->type == LEPT_ARRAY && LEPT_ARRAY_OWNED(v));
+    if (lept_get_array_capacity(v) < capacity)
+        v->u.a.e = lept_array_realloc(v->u.a.e, capacity);
+}
+
+void lept_shrink_array(lept_value *v) {
+    assert(v != NULL && v->type == LEPT_ARRAY && LEPT_ARRAY_OWNED(v));
+    if (lept_get_array_capacity(v) > v->u.a.size) {
+        if (v->u.a.size == 0) {
+            free(LEPT_ARRAY_HEADER(v->u.a.e));
+            v->u.a.e = NULL;
+        }
+        else
+            v->u.a.e = lept_array_realloc(v->u.a.e, v->u.a.size);
+    }
+}
+
+void lept_clear_array(lept_value *v) {
+    assert(v != NULL && v->type == LEPT_ARRAY);
+    lept_erase_array_element(v, 0, v->u.a.size);
+}
+
+// 容量按2倍增长，均摊O(1)
+lept_value *lept_pushback_array_element(lept_value *v) {
+    size_t capacity;
+    assert(v != NULL && v->type == LEPT_ARRAY && LEPT_ARRAY_OWNED(v));
+    if (v->u.a.size == (capacity = lept_get_array_capacity(v)))
+        lept_reserve_array(v, capacity == 0 ? 1 : capacity * 2);
+    lept_init(&v->u.a.e[v->u.a.size]);
+    return &v->u.a.e[v->u.a.size++];
+}
+
+void lept_popback_array_element(lept_value *v) {
+    assert(v != NULL && v->type == LEPT_ARRAY && LEPT_ARRAY_OWNED(v) && v->u.a.size > 0);
+    lept_free(&v->u.a.e[--v->u.a.size]);
+}
+
+lept_value *lept_insert_array_element(lept_value *v, size_t index) {
+    size_t capacity;
+    assert(v != NULL && v->type == LEPT_ARRAY && LEPT_ARRAY_OWNED(v) && index <= v->u.a.size);
+    if (v->u.a.size == (capacity = lept_get_array_capacity(v)))
+        lept_reserve_array(v, capacity == 0 ? 1 : capacity * 2);
+    memmove(&v->u.a.e[index + 1], &v->u.a.e[index], (v->u.a.size - index) * sizeof(lept_value));
+    v->u.a.size++;
+    lept_init(&v->u.a.e[index]);
+    return &v->u.a.e[index];
+}
+
+void lept_erase_array_element(lept_value *v, size_t index, size_t count) {
+    size_t i;
+    assert(v != NULL && v->type == LEPT_ARRAY && LEPT_ARRAY_OWNED(v) && index + count <= v->u.a.size);
+    if (count == 0)
+        return;
+    for (i = index; i < index + count; i++)
+        lept_free(&v->u.a.e[i]);
+    memmove(&v->u.a.e[index], &v->u.a.e[index + count], (v->u.a.size - index - count) * sizeof(lept_value));
+    v->u.a.size -= count;
+}
+
+int lept_path_compile(lept_path *p, const char *pointer) {
+    size_t i, n = 0;
+    const char *q;
+    char *d;
+    assert(p != NULL && pointer != NULL);
+    p->tokens = NULL;
+    p->size = 0;
+    p->buf = NULL;
+    if (*pointer == '\0')       // ""指向整个文档
+        return LEPT_PARSE_OK;
+    if (*pointer != '/')
+        return LEPT_PATH_INVALID_POINTER;
+    for (q = pointer; *q; q++)
+        if (*q == '/')
+            n++;
+    // 反转义后token不会变长，每个'/'的位置恰好留给'\0'
+    p->buf = (char *)malloc(strlen(pointer));
+    p->tokens = (lept_path_token *)malloc(n * sizeof(lept_path_token));
+    d = p->buf;
+    for (q = pointer; *q; ) {
+        lept_path_token *t = &p->tokens[p->size++];
+        t->s = d;
+        for (q++; *q && *q != '/'; q++) {
+            if (*q == '~') {
+                q++;
+                if (*q == '0') *d++ = '~';
+                else if (*q == '1') *d++ = '/';
+                else {
+                    lept_path_free(p);
+                    return LEPT_PATH_INVALID_POINTER;
+                }
+            }
+            else
+                *d++ = *q;
+        }
+        t->len = d - t->s;
+        *d++ = '\0';
+        // 数组下标: "0"或不以0开头的十进制数，溢出时视为普通成员名
+        t->index = 0;
+        t->is_index = t->len > 0 && (t->len == 1 || t->s[0] != '0');
+        for (i = 0; t->is_index && i < t->len; i++) {
+            if (!ISDIGIT(t->s[i]) || t->index > ((size_t)-1 - 9) / 10)
+                t->is_index = 0;
+            else
+                t->index = t->index * 10 + (t->s[i] - '0');
+        }
+    }
+    return LEPT_PARSE_OK;
+}
+
+void lept_path_free(lept_path *p) {
+    assert(p != NULL);
+    free(p->tokens);
+    free(p->buf);
+    p->tokens = NULL;
+    p->size = 0;
+    p->buf = NULL;
+}
+
+lept_value *lept_path_eval(const lept_value *v, const lept_path *p) {
+    size_t i;
+    assert(v != NULL && p != NULL);
+    for (i = 0; i < p->size; i++) {
+        const lept_path_token *t = &p->tokens[i];
+        if (v->type != LEPT_ARRAY || !t->is_index || t->index >= v->u.a.size)
+            return NULL;
+        v = &v->u.a.e[t->index];
+    }
+    return (lept_value *)v;
+}
+
+static int lept_path_parse_value(lept_context *c, lept_value *v, const lept_path *p, size_t depth, int *found);
+
+// 对象按成员名匹配token(流式求值不需要DOM支持对象)，重复的成员取第一个
+static int lept_path_parse_object(lept_context *c, lept_value *v, const lept_path *p, size_t depth, int *found) {
+    const lept_path_token *t = &p->tokens[depth];
+    const char *key;
+    size_t len;
+    int ret, match;
+    EXPECT(c, '{');
+    lept_parse_whitespace(c);
+    if (*c->json == '}') {
+        c->json++;
+        return LEPT_PARSE_OK;
+    }
+    for (;;) {
+        if ((ret = lept_parse_key(c, &key, &len)) != LEPT_PARSE_OK)
+            return ret;
+        match = !*found && len == t->len && memcmp(key, t->s, len) == 0;
+        lept_parse_whitespace(c);
+        if (*c->json != ':')
+            return LEPT_PARSE_MISS_COLON;
+        c->json++;
+        lept_parse_whitespace(c);
+        if (match)
+            ret = lept_path_parse_value(c, v, p, depth + 1, found);
+        else
+            ret = lept_skip_value(c);
+        if (ret != LEPT_PARSE_OK)
+            return ret;
+        lept_parse_whitespace(c);
+        if (*c->json == ',') {
+            c->json++;
+            lept_parse_whitespace(c);
+        }
+        else if (*c->json == '}') {
+            c->json++;
+            return LEPT_PARSE_OK;
+        }
+        else
+            return LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+    }
+}
+
+static int lept_path_parse_value(lept_context *c, lept_value *v, const lept_path *p, size_t depth, int *found) {
+    const lept_path_token *t;
+    size_t i;
+    int ret;
+    if (depth == p->size) {
+        *found = 1;
+        return lept_parse_value(c, v);
+    }
+    t = &p->tokens[depth];
+    if (*c->json == '{')
+        return lept_path_parse_object(c, v, p, depth, found);
+    if (*c->json != '[' || !t->is_index)
+        return lept_skip_value(c);
+    EXPECT(c, '[');
+    lept_parse_whitespace(c);
+    if (*c->json == ']') {
+        c->json++;
+        return LEPT_PARSE_OK;
+    }
+    for (i = 0;; i++) {
+        if (i == t->index)
+            ret = lept_path_parse_value(c, v, p, depth + 1, found);
+        else
+            ret = lept_skip_value(c);
+        if (ret != LEPT_PARSE_OK)
+            return ret;
+        lept_parse_whitespace(c);
+        if (*c->json == ',') {
+            c->json++;
+            lept_parse_whitespace(c);
+        }
+        else if (*c->json == ']') {
+            c->json++;
+            return LEPT_PARSE_OK;
+        }
+        else
+            return LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET;
+    }
+}
+
+int lept_path_parse(lept_value *v, const char *json, const lept_path *p) {
+    lept_context c;
+    int ret, found = 0;
+    assert(v != NULL && p != NULL);
+    c.json = json;
+    c.stack = NULL;
+    c.size = c.top = 0;
+    lept_init(v);
+    lept_parse_whitespace(&c);
+    if ((ret = lept_path_parse_value(&c, v, p, 0, &found)) == LEPT_PARSE_OK) {
+        lept_parse_whitespace(&c);
+        if (*c.json != '\0')
+            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+        else if (!found)
+            ret = LEPT_PATH_NOT_FOUND;
+    }
+    if (ret != LEPT_PARSE_OK)
+        lept_free(v);
+    assert(c.top == 0);
+    free(c.stack);
+    return ret;
+}
+
+#define LEPT_BINARY_MAGIC "LEPB"
+#define LEPT_BINARY_MAGIC_LEN 4
+
+static void lept_encode_binary_size(lept_context *c, size_t n) {
+    uint32_t u = (uint32_t)n;
+    assert(n <= UINT32_MAX);     // 长度和元素个数用4字节存储
+    memcpy(lept_context_push(c, sizeof(u)), &u, sizeof(u));
+}
+
+static void lept_encode_binary_value(lept_context *c, const lept_value *v) {
+    size_t i;
+    PUTC(c, (char)v->type);
+    switch (v->type) {
+        case LEPT_NUMBER:
+            memcpy(lept_context_push(c, sizeof(double)), &v->u.n, sizeof(double));
+            break;
+        case LEPT_STRING:
+            lept_encode_binary_size(c, v->u.s.len);
+            // 保留结尾'\0'，视图解码时字符串可直接指向blob
+            memcpy(lept_context_push(c, v->u.s.len + 1), v->u.s.s, v->u.s.len + 1);
+            break;
+        case LEPT_ARRAY:
+            lept_encode_binary_size(c, v->u.a.size);
+            for (i = 0; i < v->u.a.size; i++)
+                lept_encode_binary_value(c, &v->u.a.e[i]);
+            break;
+        default: break;
+    }
+}
+
+char *lept_encode_binary(const lept_value *v, size_t *length) {
+    lept_context c;
+    assert(v != NULL);
+    c.stack = NULL;
+    c.size = c.top = 0;
+    memcpy(lept_context_push(&c, LEPT_BINARY_MAGIC_LEN), LEPT_BINARY_MAGIC, LEPT_BINARY_MAGIC_LEN);
+    lept_encode_binary_value(&c, v);
+    if (length)
+        *length = c.top;
+    return c.stack;
+}
+
+// 校验blob并统计元素块的总字节数，解码前先扫描一遍，之后的解码不再做边界检查
+static const char *lept_scan_binary(const char *p, const char *end, size_t *nodes) {
+    uint32_t n;
+    size_t i;
+    if (p == end)
+        return NULL;
+    switch (*p++) {
+        case LEPT_NULL:
+        case LEPT_FALSE:
+        case LEPT_TRUE:
+            return p;
+        case LEPT_NUMBER:
+            return (size_t)(end - p) < sizeof(double) ? NULL : p + sizeof(double);
+        case LEPT_STRING:
+            if ((size_t)(end - p) < sizeof(n))
+                return NULL;
+            memcpy(&n, p, sizeof(n));
+            p += sizeof(n);
+            if (n >= (uint32_t)(end - p) || p[n] != '\0')
+                return NULL;
+            return p + n + 1;
+        case LEPT_ARRAY:
+            if ((size_t)(end - p) < sizeof(n))
+                return NULL;
+            memcpy(&n, p, sizeof(n));
+            p += sizeof(n);
+            if (n > (uint32_t)(end - p))     // 每个元素至少1字节
+                return NULL;
+            *nodes += (size_t)n * sizeof(lept_value);
+            for (i = 0; i < n; i++)
+                if (!(p = lept_scan_binary(p, end, nodes)))
+                    return NULL;
+            return p;
+        default:
+            return NULL;
+    }
+}
+
+static const char *lept_check_binary(const char *blob, size_t length, size_t *nodes) {
+    const char *end = blob + length;
+    assert(blob != NULL || length == 0);
+    *nodes = 0;
+    if (length < LEPT_BINARY_MAGIC_LEN || memcmp(blob, LEPT_BINARY_MAGIC, LEPT_BINARY_MAGIC_LEN) != 0)
+        return NULL;
+    blob = lept_scan_binary(blob + LEPT_BINARY_MAGIC_LEN, end, nodes);
+    return blob == end ? blob : NULL;
+}
+
+// pool非NULL时为视图模式：字符串指向blob，数组元素从*pool中顺序分配；否则逐个malloc
+static const char *lept_decode_binary_value(lept_value *v, const char *p, char **pool) {
+    uint32_t n;
+    size_t i;
+    v->type = (lept_type)*p++;
+    v->borrowed = pool != NULL;
+    switch (v->type) {
+        case LEPT_NUMBER:
+            memcpy(&v->u.n, p, sizeof(double));
+            return p + sizeof(double);
+        case LEPT_STRING:
+            memcpy(&n, p, sizeof(n));
+            p += sizeof(n);
+            v->u.s.len = (size_t)n;
+            if (pool)
+                v->u.s.s = (char *)p;
+            else {
+                v->u.s.s = (char *)malloc(v->u.s.len + 1);
+                memcpy(v->u.s.s, p, v->u.s.len + 1);
+            }
+            return p + n + 1;
+        case LEPT_ARRAY:
+            memcpy(&n, p, sizeof(n));
+            p += sizeof(n);
+            v->u.a.size = (size_t)n;
+            if (n == 0)
+                v->u.a.e = NULL;
+            else if (pool)
+                v->u.a.e = lept_array_borrow(pool, v->u.a.size);
+            else
+                v->u.a.e = lept_array_realloc(NULL, v->u.a.size);
+            for (i = 0; i < n; i++)
+                p = lept_decode_binary_value(&v->u.a.e[i], p, pool);
+            return p;
+        default:
+            return p;
+    }
+}
+
+int lept_decode_binary(lept_value *v, const char *blob, size_t length) {
+    size_t nodes;
+    assert(v != NULL);
+    lept_init(v);
+    if (!lept_check_binary(blob, length, &nodes))
+        return LEPT_BINARY_INVALID;
+    lept_decode_binary_value(v, blob + LEPT_BINARY_MAGIC_LEN, NULL);
+    return LEPT_PARSE_OK;
+}
+
+int lept_decode_binary_view(lept_value *v, const char *blob, size_t length) {
+    size_t nodes;
+    char *pool;
+    assert(v != NULL);
+    lept_init(v);
+    if (!lept_check_binary(blob, length, &nodes))
+        return LEPT_BINARY_INVALID;
+    pool = nodes ? (char *)malloc(nodes) : NULL;
+    lept_decode_binary_value(v, blob + LEPT_BINARY_MAGIC_LEN, &pool);
+    return LEPT_PARSE_OK;
+}
+
+void lept_free_binary_view(lept_value *v) {
+    assert(v != NULL);
+    // 根节点的元素块位于pool起始处，整个视图只有这一次分配
+    if (v->type == LEPT_ARRAY)
+        free(v->u.a.e);
+    lept_init(v);
+}
+// key可能含有\u0000解码出的'\0'，不能用strncmp
+static const lept_field *lept_bind_find(const lept_field *fields, const char *key, size_t len) {
+    size_t i;
+    for (; fields->name; fields++) {
+        for (i = 0; i < len && fields->name[i] != '\0' && fields->name[i] == key[i]; i++);
+        if (i == len && fields->name[len] == '\0')
+            return fields;
+    }
+    return NULL;
+}
+
+static int lept_bind_object(lept_context *c, char *base, const lept_field *fields);
+
+// 按字段类型直接写入p，字面量和数字借用lept_parse_value(不分配内存)
+static int lept_bind_value(lept_context *c, char *p, const lept_field *f) {
+    lept_value v;
+    char *s;
+    size_t len;
+    int ret;
+    switch (*c->json) {
+        case '{':
+            if (f->type != LEPT_BIND_OBJECT)
+                return LEPT_BIND_TYPE_MISMATCH;
+            return lept_bind_object(c, p, f->fields);
+        case '"':
+            if (f->type != LEPT_BIND_STRING)
+                return LEPT_BIND_TYPE_MISMATCH;
+            if ((ret = lept_parse_string_raw(c, &s, &len)) != LEPT_PARSE_OK)
+                return ret;
+            free(*(char **)p);      // 重复的成员以最后一个为准
+            *(char **)p = (char *)malloc(len + 1);
+            memcpy(*(char **)p, s, len);
+            (*(char **)p)[len] = '\0';
+            return LEPT_PARSE_OK;
+        case '[':
+            return LEPT_BIND_TYPE_MISMATCH;
+        default:
+            lept_init(&v);
+            if ((ret = lept_parse_value(c, &v)) != LEPT_PARSE_OK)
+                return ret;
+            switch (v.type) {
+                case LEPT_NULL:
+                    return LEPT_PARSE_OK;
+                case LEPT_TRUE:
+                case LEPT_FALSE:
+                    if (f->type != LEPT_BIND_BOOLEAN)
+                        return LEPT_BIND_TYPE_MISMATCH;
+                    *(int *)p = v.type == LEPT_TRUE;
+                    return LEPT_PARSE_OK;
+                default:
+                    if (f->type == LEPT_BIND_NUMBER)
+                        *(double *)p = v.u.n;
+                    else if (f->type == LEPT_BIND_INT && v.u.n >= INT_MIN && v.u.n <= INT_MAX
+                        && v.u.n == (double)(int)v.u.n)      // 带小数部分的数不能静默截断
+                        *(int *)p = (int)v.u.n;
+                    else
+                        return LEPT_BIND_TYPE_MISMATCH;
+                    return LEPT_PARSE_OK;
+            }
+    }
+}
+
+static int lept_bind_object(lept_context *c, char *base, const lept_field *fields) {
+    const lept_field *f;
+    const char *key;
+    size_t len;
+    int ret;
+    EXPECT(c, '{');
+    lept_parse_whitespace(c);
+    if (*c->json == '}') {
+        c->json++;
+        return LEPT_PARSE_OK;
+    }
+    for (;;) {
+        if ((ret = lept_parse_key(c, &key, &len)) != LEPT_PARSE_OK)
+            return ret;
+        f = lept_bind_find(fields, key, len);
+        lept_parse_whitespace(c);
+        if (*c->json != ':')
+            return LEPT_PARSE_MISS_COLON;
+        c->json++;
+        lept_parse_whitespace(c);
+        if (f)
+            ret = lept_bind_value(c, base + f->offset, f);
+        else
+            ret = lept_skip_value(c);       // 未知成员只做语法检查
+        if (ret != LEPT_PARSE_OK)
+            return ret;
+        lept_parse_whitespace(c);
+        if (*c->json == ',') {
+            c->json++;
+            lept_parse_whitespace(c);
+        }
+        else if (*c->json == '}') {
+            c->json++;
+            return LEPT_PARSE_OK;
+        }
+        else
+            return LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET;
+    }
+}
+
+int lept_parse_bind(void *out, const lept_field *fields, const char *json) {
+    lept_context c;
+    int ret;
+    assert(out != NULL && fields != NULL && json != NULL);
+    c.json = json;
+    c.stack = NULL;
+    c.size = c.top = 0;
+    lept_parse_whitespace(&c);
+    if (*c.json == '{')
+        ret = lept_bind_object(&c, (char *)out, fields);
+    else if ((ret = lept_skip_value(&c)) == LEPT_PARSE_OK)
+        ret = LEPT_BIND_TYPE_MISMATCH;
+    if (ret == LEPT_PARSE_OK) {
+        lept_parse_whitespace(&c);
+        if (*c.json != '\0')
+            ret = LEPT_PARSE_ROOT_NOT_SINGULAR;
+    }
+    if (ret != LEPT_PARSE_OK)
+        lept_free_bind(out, fields);
+    assert(c.top == 0);
+    free(c.stack);
+    return ret;
+}
+
+void lept_free_bind(void *out, const lept_field *fields) {
+    assert(out != NULL && fields != NULL);
+    for (; fields->name; fields++) {
+        char *p = (char *)out + fields->offset;
+        if (fields->type == LEPT_BIND_STRING) {
+            free(*(char **)p);
+            *(char **)p = NULL;
+        }
+        else if (fields->type == LEPT_BIND_OBJECT)
+            lept_free_bind(p, fields->fields);
+    }
+}
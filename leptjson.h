@@ -20,11 +20,12 @@ typedef struct lept_value lept_value;       // lept_value使用了自身类型
 // lept_value事实上是一种变体类型(variant type)：通过type类型决定那些成员是有效的
 typedef struct lept_value {
     union {
-        struct { lept_value *e; size_t size; } a;     // array size元素个数
+        struct { lept_value *e; size_t size; } a;     // array size元素个数，容量记录在e之前的头部
         struct { char *s; size_t len; } s;       // string
         double n;
     } u;
     lept_type type;
+    int borrowed;       // u.a.e/u.s.s借用自lept_copy_into的块或二进制视图，lept_free不释放
 } lept_value;
 
 // 返回值
@@ -39,16 +40,48 @@ enum {
     LEPT_PARSE_INVALID_STRING_CHAR,
     LEPT_PARSE_INVALID_UNICODE_HEX,
     LEPT_PARSE_INVALID_UNICODE_SURROGATE,
-    LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET
+    LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET,
+    LEPT_PATH_INVALID_POINTER,
+    LEPT_PATH_NOT_FOUND,
+    LEPT_BINARY_INVALID,
+    LEPT_PARSE_MISS_KEY,
+    LEPT_PARSE_MISS_COLON,
+    LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET,
+    LEPT_BIND_TYPE_MISMATCH
 };
 
+// JSON Pointer(RFC 6901)预编译结果，编译一次后可对任意多个文档求值
+typedef struct {
+    char *s; size_t len;        // 已反转义(~0 ~1)的reference token
+    size_t index;               // 数组下标，is_index为真时有效
+    int is_index;               // token是否为合法的数组下标("0"或不以0开头的数字)
+} lept_path_token;
+
+typedef struct {
+    lept_path_token *tokens;
+    size_t size;                // token个数，空指针""为0，指向根节点
+    char *buf;                  // 所有token字符串共用的缓冲区
+} lept_path;
+
 // API函数
 
-#define lept_init(v) do {(v)->type = LEPT_NULL;} while(0)
+#define lept_init(v) do {(v)->type = LEPT_NULL; (v)->borrowed = 0;} while(0)
 int lept_parse(lept_value *v, const char *json);
+// 根为数组的大文档按顶层元素切分后多线程解析，结果和错误码与lept_parse相同
+int lept_parse_parallel(lept_value *v, const char *json, int threads);
 void lept_free(lept_value *v);
 lept_type lept_get_type(const lept_value *v);
 
+void lept_copy(lept_value *dst, const lept_value *src);
+void lept_move(lept_value *dst, lept_value *src);
+void lept_swap(lept_value *lhs, lept_value *rhs);
+// 拷贝到调用者提供的一块内存(如arena)中：buf至少lept_copy_size(src)字节且按malloc对齐，
+// dst只在buf有效期间可用，由调用者释放buf；dst及其子节点只读，不可调用lept_set_*、lept_swap
+// 或数组修改函数(reserve/shrink/clear/pushback/popback/insert/erase)，需要修改时先lept_copy；
+// 其中的值都带borrowed标记：lept_free只置为null不释放内存，lept_move不转移所有权而是深拷贝(源不变)
+size_t lept_copy_size(const lept_value *src);
+void lept_copy_into(lept_value *dst, const lept_value *src, void *buf);
+
 #define lept_set_null(v) lept_free(v)
 
 int lept_get_boolean(const lept_value *v);
@@ -57,11 +90,62 @@ double lept_get_number(const lept_value *v);
 void lept_set_number(lept_value *v, double n);
 size_t lept_get_array_size(const lept_value *v);
 lept_value *lept_get_array_element(const lept_value *v, size_t index);
+void lept_set_array(lept_value *v, size_t capacity);
+size_t lept_get_array_capacity(const lept_value *v);
+void lept_reserve_array(lept_value *v, size_t capacity);
+void lept_shrink_array(lept_value *v);
+void lept_clear_array(lept_value *v);
+lept_value *lept_pushback_array_element(lept_value *v);
+void lept_popback_array_element(lept_value *v);
+lept_value *lept_insert_array_element(lept_value *v, size_t index);
+void lept_erase_array_element(lept_value *v, size_t index, size_t count);
 
 const char* lept_get_string(const lept_value *v);
 size_t lept_get_string_length(const lept_value *v);
 void lept_set_string(lept_value *v, const char *s, size_t len);
 
+int lept_path_compile(lept_path *p, const char *pointer);
+void lept_path_free(lept_path *p);
+// lept_value树中没有对象，只有数组下标token能匹配
+lept_value *lept_path_eval(const lept_value *v, const lept_path *p);
+// 流式求值：解析时只构建指针指向的值，其余子树只做语法检查不分配内存
+// 对象按成员名匹配，但指向的值本身须能用lept_value表示(不能是对象或含有对象)
+int lept_path_parse(lept_value *v, const char *json, const lept_path *p);
+
+// 按字段表把JSON对象直接解析到调用者的结构体中，不构建lept_value树
+typedef enum {
+    LEPT_BIND_BOOLEAN,      // int，0或1
+    LEPT_BIND_INT,          // int
+    LEPT_BIND_NUMBER,       // double
+    LEPT_BIND_STRING,       // char*，malloc分配并以'\0'结尾
+    LEPT_BIND_OBJECT        // 嵌套结构体，字段表由fields给出
+} lept_bind_type;
+
+typedef struct lept_field lept_field;
+struct lept_field {
+    const char *name;           // 成员名，字段表以name为NULL的项结束
+    size_t offset;              // 在结构体中的偏移，用offsetof()计算
+    lept_bind_type type;
+    const lept_field *fields;   // LEPT_BIND_OBJECT的字段表
+};
+
+// out中的字符串字段须预先置为NULL；未知成员被跳过，值为null或缺失的字段保持原值
+// 出错时已解析的字符串会被释放；成功后用lept_free_bind释放字符串字段
+int lept_parse_bind(void *out, const lept_field *fields, const char *json);
+void lept_free_bind(void *out, const lept_field *fields);
+
+// 二进制格式：用于缓存，本机字节序，不做跨平台交换
+// blob = "LEPB" value
+// value = type(1字节) [ double(8字节) / len(4字节) 字符 '\0' / count(4字节) *value ]
+char *lept_encode_binary(const lept_value *v, size_t *length);
+int lept_decode_binary(lept_value *v, const char *blob, size_t length);
+// 只读视图：字符串直接指向blob(blob须在视图使用期间保持有效，可以是mmap的只读内存)，
+// 所有数组元素共用一次分配；必须用lept_free_binary_view释放；视图及其子节点只读，规则与
+// lept_copy_into相同：值都带borrowed标记，lept_free不释放内存，lept_move深拷贝，不可lept_swap、
+// lept_set_*或调用数组修改函数，需要修改时先lept_copy
+int lept_decode_binary_view(lept_value *v, const char *blob, size_t length);
+void lept_free_binary_view(lept_value *v);
+
 // JSON语法子集
 
 // JSON-text = ws value ws
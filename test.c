@@ -2,6 +2,7 @@
 #define _CRTDBG_MAP_ALLOC
 #include <crtdbg.h>
 #endif
+#include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -159,6 +160,11 @@ static void test_parse_expect_value() {
 static void test_parse_invalid_value() {
     printf("Parse invalid value ...\n");
     TEST_ERROR(LEPT_PARSE_INVALID_VALUE, "nul");
+    TEST_ERROR(LEPT_PARSE_INVALID_VALUE, "n");
+    TEST_ERROR(LEPT_PARSE_INVALID_VALUE, "tru");
+    TEST_ERROR(LEPT_PARSE_INVALID_VALUE, "fals");
+    TEST_ERROR(LEPT_PARSE_INVALID_VALUE, "nulL");
+    TEST_ERROR(LEPT_PARSE_INVALID_VALUE, "fAlse");
     TEST_ERROR(LEPT_PARSE_INVALID_VALUE, "?");
 
     /* invalid number */
@@ -176,6 +182,8 @@ static void test_parse_invalid_value() {
 static void test_parse_root_not_singular() {
     printf("Parse root not singular ...\n");
     TEST_ERROR(LEPT_PARSE_ROOT_NOT_SINGULAR, "null x");
+    TEST_ERROR(LEPT_PARSE_ROOT_NOT_SINGULAR, "truex");
+    TEST_ERROR(LEPT_PARSE_ROOT_NOT_SINGULAR, "\n                                  \t null                  x");
 
     /* invalid number */
     TEST_ERROR(LEPT_PARSE_ROOT_NOT_SINGULAR, "0123"); /* after zero should be '.' or nothing */
@@ -297,6 +305,16 @@ static void test_access_string() {
     (size_t)_expect, (size_t)_actual, "%zu")
 #endif
 
+// 用二进制编码比较两棵树是否完全相同
+static int lept_value_same(const lept_value *a, const lept_value *b) {
+    size_t la, lb;
+    char *ba = lept_encode_binary(a, &la), *bb = lept_encode_binary(b, &lb);
+    int same = la == lb && memcmp(ba, bb, la) == 0;
+    free(ba);
+    free(bb);
+    return same;
+}
+
 static void test_parse_array() {
     printf("Parse array ...\n");
     lept_value v;
@@ -320,6 +338,24 @@ static void test_parse_array() {
     for(int i=0; i<4; ++i)
         EXPECT_EQ_INT(LEPT_ARRAY, lept_get_type(lept_get_array_element(&v, i)));
     lept_free(&v);
+
+    /* 美化输出的缩进 */
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "[\n    [\n                         true,\r\n    \t                  false\n    ],\n"
+        "                                                                null\n]\n                                   "));
+    EXPECT_EQ_SIZE_T(2, lept_get_array_size(&v));
+    EXPECT_EQ_INT(LEPT_FALSE, lept_get_type(lept_get_array_element(lept_get_array_element(&v, 0), 1)));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(lept_get_array_element(&v, 1)));
+    lept_free(&v);
+    printf("Done\n");
+}
+
+static void test_parse_miss_comma_or_square_bracket() {
+    printf("Parse miss comma or square bracket ...\n");
+    TEST_ERROR(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[1");
+    TEST_ERROR(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[1}");
+    TEST_ERROR(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[1 2");
+    TEST_ERROR(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "[[]");
+    TEST_ERROR(LEPT_PARSE_INVALID_VALUE, "[\"a\", nul]");
     printf("Done\n");
 }
 
@@ -340,6 +376,152 @@ static void test_parse() {
     test_parse_invalid_unicode_hex();
     test_parse_invalid_unicode_surrogate();
     test_parse_array();
+    test_parse_miss_comma_or_square_bracket();
+}
+
+static void test_access_array() {
+    printf("Access array ...\n");
+    lept_value a, e;
+    size_t i, j;
+    lept_init(&a);
+
+    for (j = 0; j <= 5; j += 5) {
+        lept_set_array(&a, j);
+        EXPECT_EQ_SIZE_T(0, lept_get_array_size(&a));
+        EXPECT_EQ_SIZE_T(j, lept_get_array_capacity(&a));
+        for (i = 0; i < 10; i++) {
+            lept_init(&e);
+            lept_set_number(&e, i);
+            lept_move(lept_pushback_array_element(&a), &e);
+            lept_free(&e);
+        }
+        EXPECT_EQ_SIZE_T(10, lept_get_array_size(&a));
+        for (i = 0; i < 10; i++)
+            EXPECT_EQ_DOUBLE((double)i, lept_get_number(lept_get_array_element(&a, i)));
+    }
+
+    lept_popback_array_element(&a);
+    EXPECT_EQ_SIZE_T(9, lept_get_array_size(&a));
+    for (i = 0; i < 9; i++)
+        EXPECT_EQ_DOUBLE((double)i, lept_get_number(lept_get_array_element(&a, i)));
+
+    lept_erase_array_element(&a, 4, 0);
+    EXPECT_EQ_SIZE_T(9, lept_get_array_size(&a));
+    lept_erase_array_element(&a, 8, 1);
+    EXPECT_EQ_SIZE_T(8, lept_get_array_size(&a));
+    lept_erase_array_element(&a, 0, 2);
+    EXPECT_EQ_SIZE_T(6, lept_get_array_size(&a));
+    for (i = 0; i < 6; i++)
+        EXPECT_EQ_DOUBLE((double)i + 2, lept_get_number(lept_get_array_element(&a, i)));
+
+    for (i = 0; i < 2; i++)
+        lept_set_number(lept_insert_array_element(&a, i), i);
+    EXPECT_EQ_SIZE_T(8, lept_get_array_size(&a));
+    for (i = 0; i < 8; i++)
+        EXPECT_EQ_DOUBLE((double)i, lept_get_number(lept_get_array_element(&a, i)));
+
+    EXPECT_TRUE(lept_get_array_capacity(&a) > 8);
+    lept_shrink_array(&a);
+    EXPECT_EQ_SIZE_T(8, lept_get_array_capacity(&a));
+    EXPECT_EQ_SIZE_T(8, lept_get_array_size(&a));
+    for (i = 0; i < 8; i++)
+        EXPECT_EQ_DOUBLE((double)i, lept_get_number(lept_get_array_element(&a, i)));
+
+    lept_set_string(&e, "Hello", 5);
+    lept_move(lept_pushback_array_element(&a), &e);
+    lept_free(&e);
+
+    i = lept_get_array_capacity(&a);
+    lept_clear_array(&a);
+    EXPECT_EQ_SIZE_T(0, lept_get_array_size(&a));
+    EXPECT_EQ_SIZE_T(i, lept_get_array_capacity(&a));
+    lept_shrink_array(&a);
+    EXPECT_EQ_SIZE_T(0, lept_get_array_capacity(&a));
+
+    lept_free(&a);
+    printf("Done\n");
+}
+
+static void test_copy_move_swap() {
+    printf("Copy move swap ...\n");
+    lept_value v1, v2, v3;
+    lept_init(&v1);
+    lept_init(&v2);
+    lept_init(&v3);
+    lept_parse(&v1, "[ \"abc\", [ 1, \"x\" ], true ]");
+    lept_copy(&v2, &v1);
+    EXPECT_TRUE(lept_get_array_element(&v2, 0) != lept_get_array_element(&v1, 0));
+    EXPECT_TRUE(lept_get_string(lept_get_array_element(&v2, 0)) != lept_get_string(lept_get_array_element(&v1, 0)));
+    EXPECT_EQ_STRING("x", lept_get_string(lept_get_array_element(lept_get_array_element(&v2, 1), 1)), 1);
+
+    lept_move(&v3, &v2);
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v2));
+    EXPECT_EQ_SIZE_T(3, lept_get_array_size(&v3));
+
+    lept_set_number(&v2, 1.0);
+    lept_swap(&v2, &v3);
+    EXPECT_EQ_DOUBLE(1.0, lept_get_number(&v3));
+    EXPECT_EQ_SIZE_T(3, lept_get_array_size(&v2));
+
+    /* 源是目标的子节点 */
+    lept_copy(&v2, lept_get_array_element(&v2, 1));
+    EXPECT_EQ_SIZE_T(2, lept_get_array_size(&v2));
+    lept_move(&v2, lept_get_array_element(&v2, 1));
+    EXPECT_EQ_STRING("x", lept_get_string(&v2), lept_get_string_length(&v2));
+    lept_free(&v1);
+    lept_free(&v2);
+    lept_free(&v3);
+    printf("Done\n");
+}
+
+static void test_copy_into() {
+    printf("Copy into ...\n");
+    lept_value v, c;
+    void *buf;
+    size_t size;
+    lept_init(&v);
+    lept_parse(&v, "[ \"ab\", [ 1, [ ], \"\" ], null ]");
+    size = lept_copy_size(&v);
+    EXPECT_TRUE(size >= 6 * sizeof(lept_value) + 4);
+    buf = malloc(size);         /* 恰好lept_copy_size字节，越界写入会被ASan发现 */
+    lept_copy_into(&c, &v, buf);
+    EXPECT_TRUE(lept_value_same(&v, &c));
+    lept_free(&v);
+    EXPECT_EQ_STRING("ab", lept_get_string(lept_get_array_element(&c, 0)), 2);
+    EXPECT_EQ_DOUBLE(1.0, lept_get_number(lept_get_array_element(lept_get_array_element(&c, 1), 0)));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(lept_get_array_element(&c, 2)));
+    /* 拷贝出的数组借用buf，没有自己的容量；修改前须先lept_copy成独立的值 */
+    EXPECT_EQ_SIZE_T(0, lept_get_array_capacity(&c));
+    EXPECT_EQ_SIZE_T(0, lept_get_array_capacity(lept_get_array_element(&c, 1)));
+    lept_init(&v);
+    lept_copy(&v, lept_get_array_element(&c, 1));
+    EXPECT_EQ_SIZE_T(3, lept_get_array_capacity(&v));
+    lept_set_boolean(lept_pushback_array_element(&v), 1);
+    EXPECT_EQ_SIZE_T(4, lept_get_array_size(&v));
+    EXPECT_EQ_SIZE_T(3, lept_get_array_size(lept_get_array_element(&c, 1)));
+    lept_free(&v);
+
+    /* 从借用的值lept_move不转移所有权，而是深拷贝，源保持不变 */
+    lept_init(&v);
+    lept_move(&v, lept_get_array_element(&c, 0));
+    EXPECT_TRUE(lept_get_string(&v) != lept_get_string(lept_get_array_element(&c, 0)));
+    EXPECT_EQ_STRING("ab", lept_get_string(lept_get_array_element(&c, 0)), 2);
+    lept_free(&v);
+    lept_move(&v, lept_get_array_element(&c, 1));
+    EXPECT_EQ_SIZE_T(3, lept_get_array_capacity(&v));
+    lept_free(&v);
+    /* lept_free对借用的值只置为null，不释放buf中的内存 */
+    lept_free(lept_get_array_element(&c, 0));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(lept_get_array_element(&c, 0)));
+    lept_free(&c);
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&c));
+    free(buf);
+
+    lept_set_number(&v, 2.0);
+    EXPECT_EQ_SIZE_T(0, lept_copy_size(&v));
+    lept_copy_into(&c, &v, NULL);
+    EXPECT_EQ_DOUBLE(2.0, lept_get_number(&c));
+    printf("Done\n");
 }
 
 static void test_access() {
@@ -347,7 +529,322 @@ static void test_access() {
     test_access_boolean();
     test_access_number();
     test_access_string();
+    test_access_array();
+    test_copy_move_swap();
+    test_copy_into();
+}
+static void test_path_compile() {
+    printf("Path compile ...\n");
+    lept_path p;
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_path_compile(&p, ""));
+    EXPECT_EQ_SIZE_T(0, p.size);
+    lept_path_free(&p);
+
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_path_compile(&p, "/a~1b/~01/3/03/-/"));
+    EXPECT_EQ_SIZE_T(6, p.size);
+    EXPECT_EQ_STRING("a/b", p.tokens[0].s, p.tokens[0].len);
+    EXPECT_EQ_STRING("~1", p.tokens[1].s, p.tokens[1].len);
+    EXPECT_FALSE(p.tokens[1].is_index);
+    EXPECT_TRUE(p.tokens[2].is_index);
+    EXPECT_EQ_SIZE_T(3, p.tokens[2].index);
+    EXPECT_FALSE(p.tokens[3].is_index);     /* 不允许前导0 */
+    EXPECT_FALSE(p.tokens[4].is_index);
+    EXPECT_EQ_STRING("", p.tokens[5].s, p.tokens[5].len);
+    lept_path_free(&p);
+
+    EXPECT_EQ_INT(LEPT_PATH_INVALID_POINTER, lept_path_compile(&p, "a"));
+    EXPECT_EQ_INT(LEPT_PATH_INVALID_POINTER, lept_path_compile(&p, "/~2"));
+    EXPECT_EQ_INT(LEPT_PATH_INVALID_POINTER, lept_path_compile(&p, "/~"));
+    printf("Done\n");
+}
+
+static void test_path_eval() {
+    printf("Path eval ...\n");
+    lept_value v;
+    lept_path p;
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "[ 0, [ \"a\", [ 1.5 ] ], true ]"));
+    lept_path_compile(&p, "/1/1/0");
+    EXPECT_EQ_DOUBLE(1.5, lept_get_number(lept_path_eval(&v, &p)));
+    lept_path_free(&p);
+    lept_path_compile(&p, "");
+    EXPECT_TRUE(lept_path_eval(&v, &p) == &v);
+    lept_path_free(&p);
+    lept_path_compile(&p, "/3");
+    EXPECT_TRUE(lept_path_eval(&v, &p) == NULL);
+    lept_path_free(&p);
+    lept_path_compile(&p, "/0/0");
+    EXPECT_TRUE(lept_path_eval(&v, &p) == NULL);
+    lept_path_free(&p);
+    lept_free(&v);
+    printf("Done\n");
+}
+
+#define TEST_PATH_PARSE(_error, _pointer, _json) \
+    do { \
+        lept_value v; \
+        lept_path p; \
+        lept_path_compile(&p, _pointer); \
+        EXPECT_EQ_INT(_error, lept_path_parse(&v, _json, &p)); \
+        EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v)); \
+        lept_path_free(&p); \
+    } while(0)
+
+static void test_path_parse() {
+    printf("Path parse ...\n");
+    lept_value v;
+    lept_path p;
+    lept_path_compile(&p, "/1/1");
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_path_parse(&v, "[ [ \"\\u00A2\" ], [ 1, \"abc\" ], [ 2 ] ]", &p));
+    EXPECT_EQ_STRING("abc", lept_get_string(&v), lept_get_string_length(&v));
+    lept_free(&v);
+    lept_path_free(&p);
+
+    lept_path_compile(&p, "");
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_path_parse(&v, " [ 1 ] ", &p));
+    EXPECT_EQ_SIZE_T(1, lept_get_array_size(&v));
+    lept_free(&v);
+    lept_path_free(&p);
+
+    /* 对象成员 */
+    lept_path_compile(&p, "/items/0");
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_path_parse(&v, "{ \"id\": { \"items\": 0 }, \"items\": [ 1 ] }", &p));
+    EXPECT_EQ_DOUBLE(1.0, lept_get_number(&v));
+    lept_free(&v);
+    lept_path_free(&p);
+
+    lept_path_compile(&p, "/a/1/b/0");
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_path_parse(&v, "{ \"a\": [ { \"b\": 0 }, { \"c\": [ ], \"b\": [ \"x\" ] } ] }", &p));
+    EXPECT_EQ_STRING("x", lept_get_string(&v), lept_get_string_length(&v));
+    lept_free(&v);
+    lept_path_free(&p);
+
+    /* 键和token都带转义："a/b"、"~"、"0" */
+    lept_path_compile(&p, "/a~1b/~0/0");
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_path_parse(&v, "{ \"a\\/b\": { \"\\u007E\": { \"0\": true } } }", &p));
+    EXPECT_EQ_INT(LEPT_TRUE, lept_get_type(&v));
+    lept_free(&v);
+    lept_path_free(&p);
+
+    TEST_PATH_PARSE(LEPT_PATH_NOT_FOUND, "/2", "[ 0, 1 ]");
+    TEST_PATH_PARSE(LEPT_PATH_NOT_FOUND, "/b", "{ \"a\": 1 }");
+    TEST_PATH_PARSE(LEPT_PATH_NOT_FOUND, "/0", "{ \"a\": 1 }");
+    TEST_PATH_PARSE(LEPT_PARSE_INVALID_VALUE, "/a", "{ \"a\": { } }");    /* 指向的值不能是对象 */
+    TEST_PATH_PARSE(LEPT_PARSE_MISS_COLON, "/a", "{ \"b\" 1 }");
+    TEST_PATH_PARSE(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "/a", "{ \"a\": 1 ]");
+    TEST_PATH_PARSE(LEPT_PARSE_MISS_KEY, "/a", "{ \"a\": 1, 2 }");
+    TEST_PATH_PARSE(LEPT_PATH_NOT_FOUND, "/0/0", "[ 0, 1 ]");
+    TEST_PATH_PARSE(LEPT_PATH_NOT_FOUND, "/a", "[ 0, 1 ]");
+    /* 跳过的子树和文档剩余部分同样要做语法检查 */
+    TEST_PATH_PARSE(LEPT_PARSE_INVALID_STRING_ESCAPE, "/1", "[ \"\\v\", 1 ]");
+    TEST_PATH_PARSE(LEPT_PARSE_MISS_COMMA_OR_SQUARE_BRACKET, "/0", "[ \"abc\" 1 ]");
+    TEST_PATH_PARSE(LEPT_PARSE_NUMBER_TOO_BIG, "/0", "[ 0, 1e309 ]");
+    TEST_PATH_PARSE(LEPT_PARSE_ROOT_NOT_SINGULAR, "/0", "[ \"abc\" ] x");
+    printf("Done\n");
 }
+
+static void test_path() {
+    test_path_compile();
+    test_path_eval();
+    test_path_parse();
+}
+static void test_binary_roundtrip(int view) {
+    lept_value v, d;
+    char *blob;
+    size_t length;
+    lept_init(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse(&v, "[ null, false, true, -1.5, \"a\\u0000b\", [ ], [ [ \"\" ], 1e-300 ] ]"));
+    blob = lept_encode_binary(&v, &length);
+    if (view)
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_decode_binary_view(&d, blob, length));
+    else
+        EXPECT_EQ_INT(LEPT_PARSE_OK, lept_decode_binary(&d, blob, length));
+    EXPECT_EQ_SIZE_T(7, lept_get_array_size(&d));
+    if (!view)
+        EXPECT_EQ_SIZE_T(7, lept_get_array_capacity(&d));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(lept_get_array_element(&d, 0)));
+    EXPECT_EQ_INT(LEPT_FALSE, lept_get_type(lept_get_array_element(&d, 1)));
+    EXPECT_EQ_INT(LEPT_TRUE, lept_get_type(lept_get_array_element(&d, 2)));
+    EXPECT_EQ_DOUBLE(-1.5, lept_get_number(lept_get_array_element(&d, 3)));
+    EXPECT_EQ_STRING("a\0b", lept_get_string(lept_get_array_element(&d, 4)), lept_get_string_length(lept_get_array_element(&d, 4)));
+    EXPECT_EQ_SIZE_T(0, lept_get_array_size(lept_get_array_element(&d, 5)));
+    EXPECT_EQ_SIZE_T(1, lept_get_array_size(lept_get_array_element(lept_get_array_element(&d, 6), 0)));
+    EXPECT_EQ_DOUBLE(1e-300, lept_get_number(lept_get_array_element(lept_get_array_element(&d, 6), 1)));
+    if (view) {
+        /* 视图只读：数组没有自己的容量，修改前须先lept_copy成独立的值 */
+        EXPECT_EQ_SIZE_T(0, lept_get_array_capacity(&d));
+        EXPECT_EQ_SIZE_T(0, lept_get_array_capacity(lept_get_array_element(&d, 6)));
+        lept_copy(&v, lept_get_array_element(&d, 6));
+        lept_pushback_array_element(&v);
+        EXPECT_EQ_SIZE_T(3, lept_get_array_size(&v));
+        EXPECT_EQ_SIZE_T(2, lept_get_array_size(lept_get_array_element(&d, 6)));
+        /* 视图中的字符串直接指向blob */
+        EXPECT_TRUE(lept_get_string(lept_get_array_element(&d, 4)) > blob);
+        EXPECT_TRUE(lept_get_string(lept_get_array_element(&d, 4)) < blob + length);
+        /* 从视图lept_move得到独立的拷贝，lept_free视图中的值不会释放blob中的内存 */
+        lept_move(&v, lept_get_array_element(&d, 4));
+        EXPECT_TRUE(lept_get_string(&v) < blob || lept_get_string(&v) >= blob + length);
+        EXPECT_EQ_INT(LEPT_STRING, lept_get_type(lept_get_array_element(&d, 4)));
+        lept_free(&v);
+        lept_free(lept_get_array_element(&d, 4));
+        EXPECT_EQ_INT(LEPT_NULL, lept_get_type(lept_get_array_element(&d, 4)));
+        lept_free_binary_view(&d);
+    }
+    else
+        lept_free(&d);
+    free(blob);
+    lept_free(&v);
+}
+
+static void test_binary() {
+    printf("Binary ...\n");
+    lept_value v;
+    char *blob;
+    size_t length;
+    test_binary_roundtrip(0);
+    test_binary_roundtrip(1);
+
+    lept_init(&v);
+    lept_set_string(&v, "Hello", 5);
+    blob = lept_encode_binary(&v, &length);
+    lept_free(&v);
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_decode_binary_view(&v, blob, length));
+    EXPECT_EQ_STRING("Hello", lept_get_string(&v), lept_get_string_length(&v));
+    lept_free_binary_view(&v);
+
+    /* 截断、魔数错误、尾部多余数据 */
+    EXPECT_EQ_INT(LEPT_BINARY_INVALID, lept_decode_binary(&v, blob, length - 1));
+    EXPECT_EQ_INT(LEPT_BINARY_INVALID, lept_decode_binary(&v, blob, 2));
+    EXPECT_EQ_INT(LEPT_BINARY_INVALID, lept_decode_binary_view(&v, blob + 1, length - 1));
+    EXPECT_EQ_INT(LEPT_NULL, lept_get_type(&v));
+    free(blob);
+    EXPECT_EQ_INT(LEPT_BINARY_INVALID, lept_decode_binary(&v, "LEPB\0\0", 6));
+    EXPECT_EQ_INT(LEPT_BINARY_INVALID, lept_decode_binary(&v, "LEPB\x09", 5));
+    EXPECT_EQ_INT(LEPT_BINARY_INVALID, lept_decode_binary(&v, "LEPB\x05\xff\xff\xff\xff\0\0\0\0", 13));
+    printf("Done\n");
+}
+
+static char *make_large_array(size_t records) {
+    size_t i, n = 0;
+    char *json = (char *)malloc(records * 64 + 16);
+    n += sprintf(json + n, " [ ");
+    for (i = 0; i < records; i++)
+        n += sprintf(json + n, "%s[ %u, \"a,[\\\"]\", [ ], true ]\n", i ? ", " : "", (unsigned)i);
+    sprintf(json + n, " ] ");
+    return json;
+}
+
+#define TEST_PARALLEL(_json) \
+    do { \
+        lept_value v1, v2; \
+        int ret1 = lept_parse(&v1, _json); \
+        EXPECT_EQ_INT(ret1, lept_parse_parallel(&v2, _json, 4)); \
+        EXPECT_TRUE(lept_value_same(&v1, &v2)); \
+        lept_free(&v1); \
+        lept_free(&v2); \
+    } while(0)
+
+static void test_parse_parallel() {
+    printf("Parse parallel ...\n");
+    char *json = make_large_array(20000);
+    size_t len = strlen(json);
+    TEST_PARALLEL(json);
+    TEST_PARALLEL("[ 1, [ 2 ], \"3\" ]");
+    TEST_PARALLEL("null");
+
+    /* 在不同位置注入错误，错误码须与串行解析一致 */
+    json[len / 2] = '\x01';
+    TEST_PARALLEL(json);
+    json[len / 2] = ' ';
+    json[len - 2] = 'x';
+    TEST_PARALLEL(json);
+    json[len - 2] = ' ';
+    json[len - 4] = ',';
+    TEST_PARALLEL(json);
+    json[len - 4] = ' ';
+    json[len - 3] = '\0';
+    TEST_PARALLEL(json);
+    json[len - 3] = ']';
+    json[len - 4] = ']';
+    TEST_PARALLEL(json);
+    json[len - 4] = ' ';
+    json[len - 3] = '}';        /* 根数组以'}'结尾 */
+    TEST_PARALLEL(json);
+    free(json);
+    printf("Done\n");
+}
+
+typedef struct {
+    int id;
+    double price;
+    char *name;
+    int paid;
+    struct { double x, y; } pos;
+} test_order;
+
+static const lept_field test_pos_fields[] = {
+    { "x", offsetof(test_order, pos.x) - offsetof(test_order, pos), LEPT_BIND_NUMBER, NULL },
+    { "y", offsetof(test_order, pos.y) - offsetof(test_order, pos), LEPT_BIND_NUMBER, NULL },
+    { NULL }
+};
+
+static const lept_field test_order_fields[] = {
+    { "id", offsetof(test_order, id), LEPT_BIND_INT, NULL },
+    { "price", offsetof(test_order, price), LEPT_BIND_NUMBER, NULL },
+    { "name", offsetof(test_order, name), LEPT_BIND_STRING, NULL },
+    { "paid", offsetof(test_order, paid), LEPT_BIND_BOOLEAN, NULL },
+    { "pos", offsetof(test_order, pos), LEPT_BIND_OBJECT, test_pos_fields },
+    { NULL }
+};
+
+#define TEST_BIND_ERROR(_error, _json) \
+    do { \
+        test_order o; \
+        memset(&o, 0, sizeof(o)); \
+        EXPECT_EQ_INT(_error, lept_parse_bind(&o, test_order_fields, _json)); \
+        EXPECT_TRUE(o.name == NULL); \
+    } while(0)
+
+static void test_parse_bind() {
+    printf("Parse bind ...\n");
+    test_order o;
+    memset(&o, 0, sizeof(o));
+    o.paid = 1;
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_bind(&o, test_order_fields,
+        " { \"id\" : 42, \"tags\": [ 1, { \"a\": [ ] } ], \"price\": 9.5, \"name\": \"x\",\n"
+        "   \"pos\": { \"y\": -1, \"z\": \"?\", \"x\": 2 }, \"n\\u0061me\": \"pen\", \"paid\": null } "));
+    EXPECT_EQ_INT(42, o.id);
+    EXPECT_EQ_DOUBLE(9.5, o.price);
+    EXPECT_EQ_STRING("pen", o.name, strlen(o.name));    /* 转义的键，重复时以最后一个为准 */
+    EXPECT_EQ_INT(1, o.paid);                           /* null保持原值 */
+    EXPECT_EQ_DOUBLE(2.0, o.pos.x);
+    EXPECT_EQ_DOUBLE(-1.0, o.pos.y);
+    lept_free_bind(&o, test_order_fields);
+    EXPECT_TRUE(o.name == NULL);
+
+    EXPECT_EQ_INT(LEPT_PARSE_OK, lept_parse_bind(&o, test_order_fields, "{}"));
+
+    TEST_BIND_ERROR(LEPT_BIND_TYPE_MISMATCH, "[ 1 ]");
+    TEST_BIND_ERROR(LEPT_BIND_TYPE_MISMATCH, "{ \"name\": \"a\", \"id\": \"1\" }");
+    TEST_BIND_ERROR(LEPT_BIND_TYPE_MISMATCH, "{ \"name\": \"a\", \"id\": 1e10 }");
+    TEST_BIND_ERROR(LEPT_BIND_TYPE_MISMATCH, "{ \"id\": 1.5 }");
+    TEST_BIND_ERROR(LEPT_BIND_TYPE_MISMATCH, "{ \"id\": -2.9 }");
+    TEST_BIND_ERROR(LEPT_BIND_TYPE_MISMATCH, "{ \"paid\": 1 }");
+    TEST_BIND_ERROR(LEPT_BIND_TYPE_MISMATCH, "{ \"pos\": [ ] }");
+    TEST_BIND_ERROR(LEPT_PARSE_MISS_KEY, "{ 1: 2 }");
+    TEST_BIND_ERROR(LEPT_PARSE_MISS_KEY, "{ \"name\": \"a\", }");
+    TEST_BIND_ERROR(LEPT_PARSE_MISS_COLON, "{ \"a\" 1 }");
+    TEST_BIND_ERROR(LEPT_PARSE_MISS_COLON, "{ \"a\": { \"b\" } }");
+    TEST_BIND_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{ \"name\": \"a\" \"id\": 1 }");
+    TEST_BIND_ERROR(LEPT_PARSE_MISS_COMMA_OR_CURLY_BRACKET, "{ \"a\": { \"b\": 1 ]");
+    TEST_BIND_ERROR(LEPT_PARSE_INVALID_STRING_ESCAPE, "{ \"name\": \"a\", \"x\": \"\\v\" }");
+    TEST_BIND_ERROR(LEPT_PARSE_NUMBER_TOO_BIG, "{ \"name\": \"a\", \"x\": -1e309 }");
+    TEST_BIND_ERROR(LEPT_PARSE_INVALID_VALUE, "{ \"name\": \"a\", \"x\": 1. }");
+    TEST_BIND_ERROR(LEPT_PARSE_INVALID_VALUE, "{ \"name\": \"a\", \"x\": - }");
+    TEST_BIND_ERROR(LEPT_PARSE_ROOT_NOT_SINGULAR, "{ \"name\": \"a\" } x");
+    printf("Done\n");
+}
+
 //
 int main(int argc, char* argv[]) {
 #ifdef _WINDOWS
@@ -355,6 +852,10 @@ int main(int argc, char* argv[]) {
 #endif
     test_parse();
     test_access();
+    test_path();
+    test_binary();
+    test_parse_parallel();
+    test_parse_bind();
     printf("%d/%d(%3.2f%%) passed\n", test_pass, test_count, test_pass*100.0/test_count);
     return main_ret;
 }
\ No newline at end of file